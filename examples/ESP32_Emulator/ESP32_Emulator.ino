@@ -0,0 +1,81 @@
+#if !defined(ARDUINO_ARCH_ESP32)
+#error "This example requires an ESP-32 architecture"
+#endif
+
+#include <LD2410.h>
+#include <LD2410Emulator.h>
+
+/* Emulator Example.
+
+Runs several emulated radars without any hardware connected. Every radar gets
+configured like a real one and a walking target is reported. Once per second
+the received frames and the faults of the emulators are printed.
+*/
+
+const uint8_t RADAR_COUNT = 16;
+
+LD2410Emulator emulator[RADAR_COUNT];
+
+LD2410* radar[RADAR_COUNT];
+
+// target walks towards the radar and stands still for a moment
+const LD2410Emulator::ScriptStep script[] = {
+    // duration, moving distance, moving energy, stationary distance, stationary energy
+    {1000, 550, 70, 0, 0},
+    {1000, 400, 80, 0, 0},
+    {1000, 250, 90, 0, 0},
+    {2000, 0, 0, 250, 60},
+};
+
+// faults which are injected into the frames
+const LD2410Emulator::Faults faults = {
+    5,   // dropRate in %
+    5,   // corruptionRate in %
+    20   // ackDelay in ms
+};
+
+uint32_t receivedFrames;
+
+void setup() {
+  Serial.begin(115200);
+
+  for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+    // the emulator is used instead of the radars uart
+    radar[i] = new LD2410(emulator[i]);
+
+    emulator[i].setScript(script, sizeof(script) / sizeof(script[0]));
+
+    if (!radar[i]->begin() || !radar[i]->setMaxDistAndDur(6, 6, 5)) {
+      Serial.printf("Radar %u: configuration failed\n", i);
+    }
+
+    // every second radar runs in engineering mode
+    radar[i]->enableEngMode(i % 2);
+
+    emulator[i].setFaults(faults);
+  }
+}
+
+void loop() {
+  static unsigned long lastPrint;
+
+  for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+    if (radar[i]->read()) {
+      receivedFrames++;
+    }
+  }
+
+  if (millis() - lastPrint >= 1000) {
+    lastPrint = millis();
+
+    uint32_t dropped = 0, corrupted = 0;
+    for (uint8_t i = 0; i < RADAR_COUNT; i++) {
+      dropped += emulator[i].statistics.framesDropped;
+      corrupted += emulator[i].statistics.framesCorrupted;
+    }
+
+    Serial.printf("frames: %lu dropped: %lu corrupted: %lu target state: %u distance: %u cm\n",
+                  (unsigned long)receivedFrames, (unsigned long)dropped, (unsigned long)corrupted,
+                  radar[0]->cyclicData.targetState, radar[0]->cyclicData.detectionDistance);
+  }
+}
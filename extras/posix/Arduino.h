@@ -0,0 +1,74 @@
+#pragma once
+
+/* Minimal Arduino API to build the library on a Linux host.
+
+Provides only what the library uses: Print, Stream, millis(), delay(),
+random() and the byte helpers.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define lowByte(w)  ((uint8_t)((w)&0xFF))
+
+template <class T>
+T min(T a, T b) {
+  return (a < b) ? a : b;
+}
+
+template <class T>
+T max(T a, T b) {
+  return (a > b) ? a : b;
+}
+
+inline unsigned long millis() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000UL + ts.tv_nsec / 1000000;
+}
+
+inline void delay(unsigned long ms) {
+  struct timespec ts = {time_t(ms / 1000), long(ms % 1000) * 1000000};
+  nanosleep(&ts, NULL);
+}
+
+inline long random(long howbig) {
+  return howbig > 0 ? rand() % howbig : 0;
+}
+
+inline void randomSeed(unsigned long seed) {
+  srand(seed);
+}
+
+class Print {
+ public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t data) = 0;
+
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size-- && write(*buffer++)) {
+      written++;
+    }
+    return written;
+  }
+
+  size_t write(int data) { return write(uint8_t(data)); }
+  size_t write(unsigned int data) { return write(uint8_t(data)); }
+  size_t write(long data) { return write(uint8_t(data)); }
+  size_t write(unsigned long data) { return write(uint8_t(data)); }
+
+  virtual void flush() {}
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+};
@@ -0,0 +1,311 @@
+/* Tests of LD2410Emulator together with the LD2410 class on a Linux host.
+
+The emulator is used directly as the Stream of the radar, the tests run in
+real time because the emulator sends a data frame every 100ms.
+
+Build and run it with: make test
+*/
+
+// standard headers first, Arduino.h may define min and max as macros
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LD2410.h>
+#include <LD2410Emulator.h>
+
+#define CHECK(condition)                                                   \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+int failures;
+
+unsigned long elapsed(unsigned long start) {
+  return millis() - start;
+}
+
+// waits for the next data frame of the radar, false on timeout
+bool waitForFrame(LD2410 &radar, unsigned long timeout = 300) {
+  unsigned long start = millis();
+  while (elapsed(start) < timeout) {
+    if (radar.read()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// writes a command frame directly to the emulator
+void sendCommand(LD2410Emulator &emulator, uint8_t cmd, const uint8_t *data, uint8_t dataSize) {
+  const uint8_t header[] = {0xFD, 0xFC, 0xFB, 0xFA, uint8_t(2 + dataSize), 0x00, cmd, 0x00};
+  const uint8_t tail[]   = {0x04, 0x03, 0x02, 0x01};
+
+  emulator.write(header, sizeof(header));
+  emulator.write(data, dataSize);
+  emulator.write(tail, sizeof(tail));
+}
+
+void testScript() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  // moving target for 200ms, then stationary target for 200ms
+  const LD2410Emulator::ScriptStep script[] = {
+      {200, 100, 80, 0, 0},
+      {200, 0, 0, 250, 60},
+  };
+  emulator.setScript(script, 2);
+
+  unsigned long start = millis();
+  int moving = 0, stationary = 0;
+
+  while (elapsed(start) < 1200) {
+    if (!radar.read()) {
+      continue;
+    }
+
+    // skip frames close to a step change
+    unsigned long time = elapsed(start) % 400;
+    if (time % 200 < 20 || time % 200 > 180) {
+      continue;
+    }
+
+    if (time < 200) {
+      CHECK(radar.cyclicData.targetState == MOVING_TARGET);
+      CHECK(radar.cyclicData.movingTargetDistance == 100);
+      CHECK(radar.cyclicData.detectionDistance == 100);
+      moving++;
+    } else {
+      CHECK(radar.cyclicData.targetState == STATIONARY_TARGET);
+      CHECK(radar.cyclicData.stationaryTargetDistance == 250);
+      CHECK(radar.cyclicData.detectionDistance == 250);
+      stationary++;
+    }
+  }
+
+  // both steps were played more than once
+  CHECK(moving >= 3);
+  CHECK(stationary >= 3);
+
+  // an empty script falls back to setTarget()
+  emulator.setTarget(300, 90, 0, 0);
+  emulator.setScript(NULL, 0);
+  CHECK(waitForFrame(radar));
+  CHECK(radar.cyclicData.movingTargetDistance == 300);
+  CHECK(radar.cyclicData.detectionDistance == 300);
+}
+
+void testEngineeringFrame() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  // moving target on gate 2, stationary target on gate 4
+  emulator.setTarget(200, 60, 300, 50);
+
+  CHECK(radar.enableEngMode(true));
+  CHECK(emulator.engineeringMode());
+  CHECK(waitForFrame(radar));
+
+  CHECK(radar.cyclicData.radarInEngineeringMode);
+  CHECK(radar.cyclicData.targetState == MOVING_AND_STATIONARY_TARGET);
+  CHECK(radar.cyclicData.movingTargetEnergy == 60);
+  CHECK(radar.cyclicData.stationaryTargetEnergy == 50);
+  CHECK(radar.cyclicData.detectionDistance == 200);
+  CHECK(radar.engineeringData.maxMovingGate == 8);
+  CHECK(radar.engineeringData.maxStationaryGate == 8);
+
+  for (uint8_t gate = 0; gate <= 8; gate++) {
+    CHECK(radar.engineeringData.movingEnergyGateN[gate] == (gate == 2 ? 60 : 0));
+    CHECK(radar.engineeringData.stationaryEnergyGateN[gate] == (gate == 4 ? 50 : 0));
+  }
+
+  // moving energy below the threshold of gate 2 isn´t reported
+  CHECK(radar.setGateSensConf(2, 70, 40));
+  CHECK(waitForFrame(radar));
+  CHECK(radar.cyclicData.targetState == STATIONARY_TARGET);
+  CHECK(radar.cyclicData.movingTargetDistance == 0);
+  CHECK(radar.engineeringData.movingEnergyGateN[2] == 60);
+
+  CHECK(radar.enableEngMode(false));
+  CHECK(waitForFrame(radar));
+  CHECK(!radar.cyclicData.radarInEngineeringMode);
+}
+
+void testMaxDistAndDur() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  // gates are only valid from 2 to 8
+  CHECK(!radar.setMaxDistAndDur(1, 5, 10));
+  CHECK(!radar.setMaxDistAndDur(5, 9, 10));
+  CHECK(emulator.parameter.maxMovingGate == 8);
+  CHECK(emulator.parameter.detectionTime == 5);
+
+  CHECK(radar.setMaxDistAndDur(5, 6, 10));
+  CHECK(radar.readParameter());
+  CHECK(radar.parameter.maxMovingGate == 5);
+  CHECK(radar.parameter.maxStationaryGate == 6);
+  CHECK(radar.parameter.detectionTime == 10);
+
+  // a target behind the maximum moving gate isn´t reported
+  emulator.setTarget(500, 90, 0, 0);
+  CHECK(waitForFrame(radar));
+  CHECK(radar.cyclicData.targetState == NO_TARGET);
+
+  CHECK(radar.factoryReset());
+  CHECK(radar.readParameter());
+  CHECK(radar.parameter.maxMovingGate == 8);
+  CHECK(radar.parameter.detectionTime == 5);
+}
+
+void testBaudRate() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  CHECK(!radar.setBaudRate(BaudRateIndex(9)));
+
+  // the new baud rate gets active after a restart
+  CHECK(radar.setBaudRate(BAUD_115200));
+  CHECK(emulator.baudRate() == BAUD_256000);
+  CHECK(radar.restart());
+  CHECK(emulator.baudRate() == BAUD_115200);
+  CHECK(!emulator.configMode());
+}
+
+void testConfigMode() {
+  LD2410Emulator emulator;
+
+  // read parameter outside the configuration mode is ignored
+  sendCommand(emulator, 0x61, NULL, 0);
+  CHECK(emulator.statistics.commandsReceived == 1);
+  CHECK(emulator.available() == 0);
+
+  const uint8_t enable[] = {0x01, 0x00};
+  sendCommand(emulator, 0xFF, enable, sizeof(enable));
+  CHECK(emulator.configMode());
+  CHECK(emulator.available() == 18);  // enable config mode acknowledge
+
+  sendCommand(emulator, 0x61, NULL, 0);
+  CHECK(emulator.available() == 18 + 38);  // read parameter acknowledge
+
+  // no data frames are sent in configuration mode
+  delay(250);
+  CHECK(emulator.available() == 18 + 38);
+}
+
+void testFaults() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  const LD2410Emulator::Faults faults = {30, 30, 0};
+  randomSeed(1);
+  emulator.setFaults(faults);
+
+  int frames          = 0;
+  unsigned long start = millis();
+  while (elapsed(start) < 3000) {
+    if (radar.read()) {
+      frames++;
+    }
+  }
+
+  const LD2410Emulator::Statistics &statistics = emulator.statistics;
+  uint32_t total = statistics.framesSent + statistics.framesDropped;
+
+  CHECK(total >= 25);
+  CHECK(statistics.framesDropped > total / 10 && statistics.framesDropped < total / 2);
+  CHECK(statistics.framesCorrupted > 0 && statistics.framesCorrupted < statistics.framesSent);
+
+  // a corrupted frame can also break the following one
+  CHECK(frames <= int(statistics.framesSent));
+  CHECK(frames >= int(statistics.framesSent - 2 * statistics.framesCorrupted));
+}
+
+void testAckDelay() {
+  LD2410Emulator emulator;
+  LD2410 radar(emulator);
+
+  // the library waits 100ms for an acknowledge
+  LD2410Emulator::Faults faults = {0, 0, 50};
+  emulator.setFaults(faults);
+  CHECK(radar.readParameter());
+
+  faults.ackDelay = 150;
+  emulator.setFaults(faults);
+  CHECK(!radar.readParameter());
+}
+
+void testOverflow() {
+  LD2410Emulator emulator;
+
+  // nobody reads the stream for one second
+  delay(1050);
+  int available = emulator.available();
+
+  // only complete frames which fit into the buffer are sent
+  CHECK(available > 0 && available <= 128);
+  CHECK(available % 23 == 0);
+  CHECK(emulator.statistics.framesSent == uint32_t(available / 23));
+  CHECK(emulator.statistics.framesSent + emulator.statistics.framesOverflowed == 10);
+}
+
+void testManyEmulators() {
+  const int RADAR_COUNT = 32;
+  static LD2410Emulator emulator[RADAR_COUNT];
+  LD2410 *radar[RADAR_COUNT];
+  int frames[RADAR_COUNT] = {};
+
+  for (int i = 0; i < RADAR_COUNT; i++) {
+    radar[i] = new LD2410(emulator[i]);
+    emulator[i].setTarget(100 + i * 10, 90, 0, 0);
+
+    CHECK(radar[i]->begin());
+    CHECK(radar[i]->setMaxDistAndDur(8, 8, 5 + i));
+    CHECK(radar[i]->setGateSensConf(3, 45, 35));
+    CHECK(radar[i]->enableEngMode(i % 2));
+    CHECK(radar[i]->readParameter());
+    CHECK(radar[i]->parameter.detectionTime == 5 + i);
+    CHECK(radar[i]->parameter.movingSensitivity[3] == 45);
+  }
+
+  unsigned long start = millis();
+  while (elapsed(start) < 1000) {
+    for (int i = 0; i < RADAR_COUNT; i++) {
+      if (radar[i]->read()) {
+        frames[i]++;
+        CHECK(radar[i]->cyclicData.movingTargetDistance == 100 + i * 10);
+        CHECK(radar[i]->cyclicData.radarInEngineeringMode == bool(i % 2));
+      }
+    }
+  }
+
+  for (int i = 0; i < RADAR_COUNT; i++) {
+    CHECK(frames[i] >= 8 && frames[i] <= 12);
+    CHECK(emulator[i].statistics.framesOverflowed == 0);
+    delete radar[i];
+  }
+}
+
+int main() {
+  testScript();
+  testEngineeringFrame();
+  testMaxDistAndDur();
+  testBaudRate();
+  testConfigMode();
+  testFaults();
+  testAckDelay();
+  testOverflow();
+  testManyEmulators();
+
+  if (failures) {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+
+  printf("all tests passed\n");
+  return 0;
+}
@@ -0,0 +1,159 @@
+/* Benchmark of the LD2410Gateway on a Linux host.
+
+Every radar is emulated with a pseudo terminal. The benchmark writes bursts
+of engineering data frames into the master side of each terminal and the
+gateway receives them from the slave side. It prints the received frames per
+second and the latency from writing the burst of a radar until a frame of it
+is parsed for 1 to 64 radars.
+
+Build and run it with: make bench
+*/
+
+// standard headers first, Arduino.h may define min and max as macros
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <LD2410.h>
+#include <LD2410Gateway.h>
+#include <LD2410PosixSerial.h>
+
+// frames written to each radar per burst
+const int BURST_FRAMES = 8;
+
+// bursts per run
+const int BURSTS = 500;
+
+// engineering data frame of a moving target in 2m distance
+const uint8_t FRAME[] = {
+    0xF4, 0xF3, 0xF2, 0xF1,                                // data header
+    0x23, 0x00,                                            // data length
+    0x01, 0xAA,                                            // engineering mode, cyclicData header
+    0x01, 0xC8, 0x00, 0x3C, 0x00, 0x00, 0x00,              // moving target 200cm 60%
+    0xC8, 0x00,                                            // detection distance
+    0x08, 0x08,                                            // max moving and stationary gate
+    0x00, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // moving energy per gate
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // stationary energy per gate
+    0x3C, 0x00,                                            // max energy
+    0x55, 0x00,                                            // cyclicData tail and check
+    0xF8, 0xF7, 0xF6, 0xF5                                 // data tail
+};
+
+struct Run {
+  uint64_t writeTime[LD2410Gateway::MAX_RADARS];  // time the burst of each radar was written in us
+  uint32_t frames;                                // received frames of the current burst
+  std::vector<uint32_t> latency;                  // latency of every received frame in us
+};
+
+uint64_t micros64() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return uint64_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+void frameReceived(uint8_t index, LD2410 &radar, void *arg) {
+  Run *run = (Run *)arg;
+
+  if (radar.cyclicData.movingTargetDistance != 200) {
+    fprintf(stderr, "radar %u: wrong distance %u\n", index, radar.cyclicData.movingTargetDistance);
+    exit(1);
+  }
+
+  run->latency.push_back(micros64() - run->writeTime[index]);
+  run->frames++;
+}
+
+bool benchmark(int radarCount) {
+  // serial ports can´t be copied, so they are kept in a fixed array
+  static LD2410PosixSerial serial[LD2410Gateway::MAX_RADARS];
+  int master[LD2410Gateway::MAX_RADARS];
+  LD2410 *radar[LD2410Gateway::MAX_RADARS];
+  LD2410Gateway gateway;
+  Run run;
+
+  if (!gateway.begin()) {
+    return false;
+  }
+
+  for (int i = 0; i < radarCount; i++) {
+    master[i] = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master[i] < 0 || grantpt(master[i]) || unlockpt(master[i])) {
+      perror("posix_openpt");
+      return false;
+    }
+
+    if (!serial[i].begin(ptsname(master[i]), BAUD_256000)) {
+      perror("LD2410PosixSerial::begin");
+      return false;
+    }
+
+    radar[i] = new LD2410(serial[i]);
+    if (gateway.add(serial[i], *radar[i]) != i) {
+      fprintf(stderr, "LD2410Gateway::add failed\n");
+      return false;
+    }
+  }
+
+  gateway.onFrame(frameReceived, &run);
+  run.latency.reserve(size_t(radarCount) * BURST_FRAMES * BURSTS);
+
+  uint8_t burst[sizeof(FRAME) * BURST_FRAMES];
+  for (int i = 0; i < BURST_FRAMES; i++) {
+    memcpy(&burst[i * sizeof(FRAME)], FRAME, sizeof(FRAME));
+  }
+
+  uint64_t start = micros64();
+
+  for (int b = 0; b < BURSTS; b++) {
+    run.frames          = 0;
+    uint64_t burstStart = micros64();
+
+    for (int i = 0; i < radarCount; i++) {
+      run.writeTime[i] = micros64();
+      if (write(master[i], burst, sizeof(burst)) != ssize_t(sizeof(burst))) {
+        perror("write");
+        return false;
+      }
+    }
+
+    // receive the burst of all radars
+    while (run.frames < uint32_t(radarCount) * BURST_FRAMES) {
+      if (gateway.poll(1000) < 0 || micros64() - burstStart > 1000000) {
+        fprintf(stderr, "timeout, received %u frames\n", run.frames);
+        return false;
+      }
+    }
+  }
+
+  double seconds = (micros64() - start) / 1e6;
+
+  std::sort(run.latency.begin(), run.latency.end());
+  size_t samples = run.latency.size();
+
+  printf("%6d %12.0f %10u %10u %10u\n", radarCount, samples / seconds,
+         run.latency[samples / 2], run.latency[samples * 99 / 100], run.latency[samples - 1]);
+
+  for (int i = 0; i < radarCount; i++) {
+    delete radar[i];
+    serial[i].end();
+    close(master[i]);
+  }
+  return true;
+}
+
+int main() {
+  printf("radars   frames/sec  p50 [us]   p99 [us]   max [us]\n");
+
+  for (int radarCount = 1; radarCount <= LD2410Gateway::MAX_RADARS; radarCount *= 2) {
+    if (!benchmark(radarCount)) {
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,327 @@
+/* Tests of LD2410PosixSerial and LD2410Gateway with pseudo terminals.
+
+The test writes frames into the master side of a pseudo terminal and checks
+what the gateway decodes from the slave side.
+
+Build and run it with: make test
+*/
+
+// standard headers first, Arduino.h may define min and max as macros
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+
+#include <LD2410.h>
+#include <LD2410Emulator.h>
+#include <LD2410Gateway.h>
+#include <LD2410PosixSerial.h>
+
+#define CHECK(condition)                                                   \
+  do {                                                                     \
+    if (!(condition)) {                                                    \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+int failures;
+
+// received data frames of the callback
+int receivedFrames;
+
+void frameReceived(uint8_t, LD2410 &, void *) {
+  receivedFrames++;
+}
+
+// index of the last disconnected radar, -1 if none
+int disconnectedIndex;
+
+void radarDisconnected(uint8_t index, LD2410 &, void *) {
+  disconnectedIndex = index;
+}
+
+/**
+ * @brief Radar connected to the slave side of a pseudo terminal
+ */
+struct PtyRadar {
+  int master;
+  LD2410PosixSerial serial;
+  LD2410 radar;
+  LD2410Gateway gateway;
+
+  PtyRadar() : radar(serial) {
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) || unlockpt(master) ||
+        !serial.begin(ptsname(master), BAUD_256000) ||
+        !gateway.begin() || gateway.add(serial, radar) != 0) {
+      perror("pseudo terminal");
+      exit(1);
+    }
+
+    gateway.onFrame(frameReceived, NULL);
+    gateway.onDisconnect(radarDisconnected, NULL);
+    receivedFrames    = 0;
+    disconnectedIndex = -1;
+  }
+
+  ~PtyRadar() {
+    if (master >= 0) {
+      close(master);
+    }
+  }
+
+  void send(const uint8_t *data, size_t size) {
+    if (write(master, data, size) != ssize_t(size)) {
+      perror("write");
+      exit(1);
+    }
+  }
+};
+
+// basic data frame of a moving target in 2m distance
+const uint8_t DATA_FRAME[] = {
+    0xF4, 0xF3, 0xF2, 0xF1,                    // data header
+    0x0D, 0x00,                                // data length
+    0x02, 0xAA,                                // basic mode, cyclicData header
+    0x01, 0xC8, 0x00, 0x3C, 0x00, 0x00, 0x00,  // moving target 200cm 60%
+    0xC8, 0x00,                                // detection distance
+    0x55, 0x00,                                // cyclicData tail and check
+    0xF8, 0xF7, 0xF6, 0xF5                     // data tail
+};
+
+// acknowledge of read firmware version V1.07.22091615
+const uint8_t FIRMWARE_ACK[] = {
+    0xFD, 0xFC, 0xFB, 0xFA,                          // command header
+    0x0C, 0x00,                                      // data length
+    0xA0, 0x01, 0x00, 0x00,                          // acknowledge, status
+    0x01, 0x00, 0x07, 0x01, 0x15, 0x16, 0x09, 0x22,  // firmware type and version
+    0x04, 0x03, 0x02, 0x01                           // command tail
+};
+
+unsigned long elapsed(unsigned long start) {
+  return millis() - start;
+}
+
+void testValidFrames() {
+  PtyRadar pty;
+
+  for (int i = 0; i < 3; i++) {
+    pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+  }
+
+  CHECK(pty.gateway.poll(100) == 3);
+  CHECK(receivedFrames == 3);
+  CHECK(pty.radar.cyclicData.targetState == MOVING_TARGET);
+  CHECK(pty.radar.cyclicData.movingTargetDistance == 200);
+  CHECK(pty.radar.cyclicData.movingTargetEnergy == 60);
+}
+
+void testCorruptedTail() {
+  PtyRadar pty;
+  uint8_t frame[sizeof(DATA_FRAME)];
+
+  memcpy(frame, DATA_FRAME, sizeof(frame));
+  frame[sizeof(frame) - 1] ^= 0xFF;
+  pty.send(frame, sizeof(frame));
+
+  for (int i = 0; i < 3; i++) {
+    pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+  }
+
+  // the valid frames behind the broken one must not wait for more data
+  CHECK(pty.gateway.poll(100) == 3);
+  CHECK(receivedFrames == 3);
+}
+
+void testInvalidFrames() {
+  PtyRadar pty;
+  uint8_t frame[sizeof(DATA_FRAME)];
+
+  // data length larger than the parser buffer
+  const uint8_t overflow[] = {0xF4, 0xF3, 0xF2, 0xF1, 0xFF, 0x00};
+  pty.send(overflow, sizeof(overflow));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  // missing cyclicData header
+  memcpy(frame, DATA_FRAME, sizeof(frame));
+  frame[7] = 0x00;
+  pty.send(frame, sizeof(frame));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  // garbage between the frames
+  const uint8_t garbage[] = {0xF4, 0xF3, 0x00, 0xFD, 0x12};
+  pty.send(garbage, sizeof(garbage));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  // data length too short for a basic frame
+  const uint8_t shortFrame[] = {0xF4, 0xF3, 0xF2, 0xF1, 0x02, 0x00, 0x01, 0xAA, 0xF8, 0xF7, 0xF6, 0xF5};
+  pty.send(shortFrame, sizeof(shortFrame));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  // firmware acknowledge without version
+  const uint8_t shortAck[] = {0xFD, 0xFC, 0xFB, 0xFA, 0x04, 0x00, 0xA0, 0x01, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01};
+  pty.send(shortAck, sizeof(shortAck));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  CHECK(pty.gateway.poll(100) == 5);
+  CHECK(receivedFrames == 5);
+  CHECK(pty.radar.firmwareVersion.majorVersion == 0);
+}
+
+void testAcknowledgeBetweenFrames() {
+  PtyRadar pty;
+
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+  pty.send(FIRMWARE_ACK, sizeof(FIRMWARE_ACK));
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+
+  // the acknowledge is decoded but not counted as data frame
+  CHECK(pty.gateway.poll(100) == 2);
+  CHECK(receivedFrames == 2);
+  CHECK(pty.radar.firmwareVersion.majorVersion == 1);
+  CHECK(pty.radar.firmwareVersion.minorVersion == 7);
+  CHECK(pty.radar.firmwareVersion.bugFixVersion == 0x22091615);
+}
+
+void testSplitFrame() {
+  PtyRadar pty;
+
+  pty.send(DATA_FRAME, 10);
+  CHECK(pty.gateway.poll(100) == 0);
+
+  pty.send(&DATA_FRAME[10], sizeof(DATA_FRAME) - 10);
+  CHECK(pty.gateway.poll(100) == 1);
+  CHECK(pty.radar.cyclicData.movingTargetDistance == 200);
+}
+
+void testHangup() {
+  PtyRadar pty;
+
+  pty.send(DATA_FRAME, sizeof(DATA_FRAME));
+  CHECK(pty.gateway.poll(100) == 1);
+
+  close(pty.master);
+  pty.master = -1;
+
+  // the hangup wakes up the gateway and the port gets removed
+  unsigned long start = millis();
+  CHECK(pty.gateway.poll(100) == 0);
+  CHECK(elapsed(start) < 90);
+  CHECK(disconnectedIndex == 0);
+  CHECK(!pty.gateway.connected(0));
+
+  // the removed port doesn´t wake up the gateway anymore
+  start = millis();
+  CHECK(pty.gateway.poll(100) == 0);
+  CHECK(elapsed(start) >= 90);
+
+  // the free index is used by the next radar
+  PtyRadar other;
+  CHECK(pty.gateway.add(other.serial, other.radar) == 0);
+  CHECK(pty.gateway.connected(0));
+
+  other.send(DATA_FRAME, sizeof(DATA_FRAME));
+  CHECK(pty.gateway.poll(100) == 1);
+  CHECK(other.radar.cyclicData.movingTargetDistance == 200);
+
+  // the index is free again after remove()
+  pty.gateway.remove(0);
+  CHECK(!pty.gateway.connected(0));
+  CHECK(pty.gateway.add(other.serial, other.radar) == 0);
+}
+
+void testSlotReuse() {
+  PtyRadar pty;
+  PtyRadar port[LD2410Gateway::MAX_RADARS];
+
+  // index 0 is used by the radar of the pseudo terminal
+  for (int i = 1; i < LD2410Gateway::MAX_RADARS; i++) {
+    CHECK(pty.gateway.add(port[i].serial, port[i].radar) == i);
+  }
+  CHECK(pty.gateway.add(port[0].serial, port[0].radar) == -1);
+
+  // unplugged radars don´t use up the indexes
+  for (int i = 1; i < LD2410Gateway::MAX_RADARS; i++) {
+    close(port[i].master);
+    port[i].master = -1;
+  }
+  pty.gateway.poll(100);
+
+  for (int i = 1; i < LD2410Gateway::MAX_RADARS; i++) {
+    CHECK(!pty.gateway.connected(i));
+  }
+  CHECK(pty.gateway.connected(0));
+  CHECK(pty.gateway.add(port[0].serial, port[0].radar) == 1);
+}
+
+void testCommands() {
+  PtyRadar pty;
+  LD2410Emulator emulator;
+  std::atomic<bool> running(true);
+
+  emulator.setTarget(300, 90, 0, 0);
+
+  // connect the emulator to the master side of the pseudo terminal
+  std::thread pump([&] {
+    fcntl(pty.master, F_SETFL, O_NONBLOCK);
+
+    while (running) {
+      uint8_t buffer[256];
+      ssize_t size = read(pty.master, buffer, sizeof(buffer));
+      if (size > 0) {
+        emulator.write(buffer, size);
+      }
+
+      size = 0;
+      while (emulator.available() && size < ssize_t(sizeof(buffer))) {
+        buffer[size++] = emulator.read();
+      }
+      if (size > 0 && write(pty.master, buffer, size) != size) {
+        break;
+      }
+      usleep(200);
+    }
+  });
+
+  CHECK(pty.radar.begin());
+  CHECK(pty.radar.firmwareVersion.majorVersion == 1);
+  CHECK(pty.radar.setGateSensConf(4, 33, 44));
+  CHECK(pty.radar.readParameter());
+  CHECK(pty.radar.parameter.movingSensitivity[4] == 33);
+  CHECK(pty.radar.parameter.stationarySensitivity[4] == 44);
+
+  unsigned long start = millis();
+  while (receivedFrames < 3 && elapsed(start) < 1000) {
+    pty.gateway.poll(100);
+  }
+  CHECK(receivedFrames >= 3);
+  CHECK(pty.radar.cyclicData.movingTargetDistance == 300);
+
+  running = false;
+  pump.join();
+}
+
+int main() {
+  testValidFrames();
+  testCorruptedTail();
+  testInvalidFrames();
+  testAcknowledgeBetweenFrames();
+  testSplitFrame();
+  testHangup();
+  testSlotReuse();
+  testCommands();
+
+  if (failures) {
+    printf("%d checks failed\n", failures);
+    return 1;
+  }
+
+  printf("all tests passed\n");
+  return 0;
+}
@@ -15,6 +15,21 @@ bool LD2410::read() {
   return (_parse() == 1);
 }
 
+bool LD2410::read(const uint8_t *data, size_t size, size_t &parsed) {
+  parsed = 0;
+
+  while (parsed < size) {
+    size_t count;
+    uint16_t res = _parse(&data[parsed], size - parsed, count);
+    parsed += count;
+
+    if (res == 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool LD2410::_sendCommand(RadarCommand cmd, const uint8_t *data, size_t dataSize) {
   if (_enableConfigMode()) {
     if (_sendRequestToRadar(cmd, data, dataSize)) {
@@ -73,192 +88,233 @@ bool LD2410::_sendCommand(RadarCommand cmd) {
   return _sendCommand(cmd, NULL, 0);
 }
 
-uint16_t LD2410::_charToUint(char c1, char c2) {
+uint16_t LD2410::_charToUint(uint8_t c1, uint8_t c2) {
   return (uint16_t)(c1 | c2 << 8);
 }
 
 uint16_t LD2410::_parse() {
-  static bool dataPayload;
-  static ParserState parserState;
-  static uint8_t dataLength, receivedBytes;
-  static uint8_t dataBuffer[40];
-
   while (_radarUart->available()) {
     uint8_t readChar = _radarUart->read();
 
-    switch (parserState) {
-      case FIND_FRAME_HEADER:
+    size_t parsed;
+    uint16_t res = _parse(&readChar, 1, parsed);
+    if (res) {
+      return res;
+    }
+  }
+  return 0;  // no data
+}
 
-        // move data until frame header is found
-        memmove(&dataBuffer[0], &dataBuffer[1], sizeof(_dataHeader) - 1);
-        dataBuffer[3] = readChar;
+uint16_t LD2410::_parse(const uint8_t *data, size_t size, size_t &parsed) {
+  parsed = 0;
 
-        // Check for data header
-        if (!memcmp(dataBuffer, _dataHeader, sizeof(_dataHeader))) {
-          dataPayload   = true;
-          parserState   = RECEIVE_DATA_LENGTH;
-          receivedBytes = 0;
-        }
+  while (parsed < size) {
+    switch (_parserState) {
+      case FIND_FRAME_HEADER: {
+        uint8_t readChar      = data[parsed++];
+        const uint8_t *header = _dataPayload ? _dataHeader : _commandHeader;
+
+        // all header bytes are different, so on a mismatch only a new header can start
+        if (_receivedBytes == 0 || readChar != header[_receivedBytes]) {
+          _receivedBytes = 0;
 
-        // Check for command header
-        if (!memcmp(dataBuffer, _commandHeader, sizeof(_commandHeader))) {
-          dataPayload   = false;
-          parserState   = RECEIVE_DATA_LENGTH;
-          receivedBytes = 0;
+          if (readChar == _dataHeader[0] || readChar == _commandHeader[0]) {
+            _dataPayload   = (readChar == _dataHeader[0]);
+            _receivedBytes = 1;
+          }
+        } else if (++_receivedBytes == sizeof(_dataHeader)) {
+          _parserState   = RECEIVE_DATA_LENGTH;
+          _receivedBytes = 0;
         }
         break;
+      }
 
       case RECEIVE_DATA_LENGTH:
+        _dataBuffer[_receivedBytes++] = data[parsed++];
 
-        dataBuffer[receivedBytes++] = readChar;
-
-        if (receivedBytes >= 2) {
-          dataLength = _charToUint(dataBuffer[0], dataBuffer[1]);
+        if (_receivedBytes >= 2) {
+          _dataLength    = _charToUint(_dataBuffer[0], _dataBuffer[1]);
+          _receivedBytes = 0;
 
           // buffer overflow check
-          if (dataLength > sizeof(dataBuffer)) {
-            parserState = FIND_FRAME_HEADER;
-            return 0;
+          if (_dataLength + sizeof(_dataTail) > sizeof(_dataBuffer)) {
+            _parserState = FIND_FRAME_HEADER;
+            break;
           }
 
-          parserState   = RECEIVE_DATA;
-          receivedBytes = 0;
+          _parserState = RECEIVE_DATA;
         }
         break;
 
-      case RECEIVE_DATA:
-        dataBuffer[receivedBytes++] = readChar;
-
-        if (receivedBytes == dataLength + sizeof(_dataTail)) {
-          if (dataPayload) {
-            // Tail not found
-            if (memcmp(&dataBuffer[dataLength], _dataTail, sizeof(_dataTail))) {
-              parserState = FIND_FRAME_HEADER;
-              return 0;
-            }
-
-            // Engineering mode active
-            _cyclicData.radarInEngineeringMode = dataBuffer[0] == 0x01;
-
-            // cyclicData Header 0XAA
-            if (dataBuffer[1] != 0xAA) {
-              parserState = FIND_FRAME_HEADER;
-              return 0;
-            }
-
-            // Target State
-            _cyclicData.targetState = (TargetState)dataBuffer[2];
-
-            // moving target distance
-            _cyclicData.movingTargetDistance = _charToUint(dataBuffer[3], dataBuffer[4]);
-
-            // moving target energy value
-            _cyclicData.movingTargetEnergy = dataBuffer[5];
-
-            // stationary target distance
-            _cyclicData.stationaryTargetDistance = _charToUint(dataBuffer[6], dataBuffer[7]);
-
-            // stationary target energy value
-            _cyclicData.stationaryTargetEnergy = dataBuffer[8];
-
-            // detection distance
-            _cyclicData.detectionDistance = _charToUint(dataBuffer[9], dataBuffer[10]);
-
-            if (_cyclicData.radarInEngineeringMode) {
-              // Maximum distance gate
-              _engineeringData.maxMovingGate     = dataBuffer[11];
-              _engineeringData.maxStationaryGate = dataBuffer[12];
-
-              // Moving energy per gate
-              for (uint8_t gate = 0; gate <= 8; gate++) {
-                _engineeringData.movingEnergyGateN[gate] = dataBuffer[13 + gate];
-              }
-
-              // Stationary energy per gate
-              for (uint8_t gate = 0; gate <= 8; gate++) {
-                _engineeringData.stationaryEnergyGateN[gate] = dataBuffer[22 + gate];
-              }
-
-              // max energy per gate
-              _engineeringData.maxMovingEnergy     = dataBuffer[31];
-              _engineeringData.maxStationaryEnergy = dataBuffer[32];
-
-              // 0x55 cyclicData tail and check (0x00)
-              if (dataBuffer[33] == 0x55 && dataBuffer[34] == 0x00) {
-                parserState = FIND_FRAME_HEADER;
-                return 1;
-              }
-
-            } else {
-              memset(&_engineeringData, 0, sizeof(_engineeringData));
-
-              // 0x55 cyclicData tail and check (0x00)
-              if (dataBuffer[11] == 0x55 && dataBuffer[12] == 0x00) {
-                parserState = FIND_FRAME_HEADER;
-                return 1;
-              }
-            }
-            parserState = FIND_FRAME_HEADER;
-            return 0;
-
-          } else {  // Command data
-
-            // Tail not found
-            if (memcmp(&dataBuffer[dataLength], _commandTail, sizeof(_commandTail))) {
-              parserState = FIND_FRAME_HEADER;
-              return false;
-            }
-
-            // Acknowledge for command data
-            uint16_t cmd = _charToUint(dataBuffer[1], dataBuffer[0]) - 1;
-
-            bool fail = _charToUint(dataBuffer[2], dataBuffer[3]) != 0;
-
-            switch (cmd) {
-              case READ_PARAMETER:
-                // parameter header
-                if (dataBuffer[4] != 0xAA) {
-                  return 0;
-                }
-
-                _parameter.maxGate           = dataBuffer[5];
-                _parameter.maxMovingGate     = dataBuffer[6];
-                _parameter.maxStationaryGate = dataBuffer[7];
-
-                for (uint8_t gate = 0; gate <= 8; gate++) {
-                  _parameter.movingSensitivity[gate] = dataBuffer[8 + gate];
-                }
-
-                for (uint8_t gate = 0; gate <= 8; gate++) {
-                  _parameter.stationarySensitivity[gate] = dataBuffer[17 + gate];
-                }
-
-                _parameter.detectionTime = _charToUint(dataBuffer[26], dataBuffer[27]);
-                break;
-              case READ_FIRMWARE_VERSION:
-
-                _firmwareVersion.minorVersion  = dataBuffer[6];
-                _firmwareVersion.majorVersion  = dataBuffer[7];
-                _firmwareVersion.bugFixVersion = uint32_t(
-                    dataBuffer[8] | dataBuffer[9] << 8 |
-                    dataBuffer[10] << 16 | dataBuffer[11] << 24);
-
-                break;
-
-              default:
-                // TODO Protocol version, radar buffer size...
-                break;
-            }
-
-            parserState = FIND_FRAME_HEADER;
-            return cmd + fail;
+      case RECEIVE_DATA: {
+        size_t frameSize = _dataLength + sizeof(_dataTail);
+        const uint8_t *frame;
+
+        if (_receivedBytes == 0 && size - parsed >= frameSize) {
+          // complete frame received, decode it in place
+          frame = &data[parsed];
+          parsed += frameSize;
+        } else {
+          // frame is split, collect it in the data buffer
+          size_t count = frameSize - _receivedBytes;
+          if (count > size - parsed) {
+            count = size - parsed;
+          }
+
+          memcpy(&_dataBuffer[_receivedBytes], &data[parsed], count);
+          _receivedBytes += count;
+          parsed += count;
+
+          if (_receivedBytes < frameSize) {
+            break;
           }
+          frame = _dataBuffer;
         }
 
+        _parserState   = FIND_FRAME_HEADER;
+        _receivedBytes = 0;
+
+        uint16_t res = _decodeFrame(frame);
+        if (res) {
+          return res;
+        }
         break;
+      }
     }
   }
-  return 0;  // no data
+  return 0;  // no complete frame
+}
+
+uint16_t LD2410::_decodeFrame(const uint8_t *frame) {
+  if (_dataPayload) {
+    // Tail not found
+    if (memcmp(&frame[_dataLength], _dataTail, sizeof(_dataTail))) {
+      return 0;
+    }
+
+    // Payload length must match the mode, 13 bytes basic (0x02) or 35 bytes engineering (0x01)
+    if (!(_dataLength == 13 && frame[0] == 0x02) && !(_dataLength == 35 && frame[0] == 0x01)) {
+      return 0;
+    }
+
+    // Engineering mode active
+    _cyclicData.radarInEngineeringMode = frame[0] == 0x01;
+
+    // cyclicData Header 0XAA
+    if (frame[1] != 0xAA) {
+      return 0;
+    }
+
+    // Target State
+    _cyclicData.targetState = (TargetState)frame[2];
+
+    // moving target distance
+    _cyclicData.movingTargetDistance = _charToUint(frame[3], frame[4]);
+
+    // moving target energy value
+    _cyclicData.movingTargetEnergy = frame[5];
+
+    // stationary target distance
+    _cyclicData.stationaryTargetDistance = _charToUint(frame[6], frame[7]);
+
+    // stationary target energy value
+    _cyclicData.stationaryTargetEnergy = frame[8];
+
+    // detection distance
+    _cyclicData.detectionDistance = _charToUint(frame[9], frame[10]);
+
+    if (_cyclicData.radarInEngineeringMode) {
+      // Maximum distance gate
+      _engineeringData.maxMovingGate     = frame[11];
+      _engineeringData.maxStationaryGate = frame[12];
+
+      // Moving energy per gate
+      for (uint8_t gate = 0; gate <= 8; gate++) {
+        _engineeringData.movingEnergyGateN[gate] = frame[13 + gate];
+      }
+
+      // Stationary energy per gate
+      for (uint8_t gate = 0; gate <= 8; gate++) {
+        _engineeringData.stationaryEnergyGateN[gate] = frame[22 + gate];
+      }
+
+      // max energy per gate
+      _engineeringData.maxMovingEnergy     = frame[31];
+      _engineeringData.maxStationaryEnergy = frame[32];
+
+      // 0x55 cyclicData tail and check (0x00)
+      if (frame[33] == 0x55 && frame[34] == 0x00) {
+        return 1;
+      }
+
+    } else {
+      memset(&_engineeringData, 0, sizeof(_engineeringData));
+
+      // 0x55 cyclicData tail and check (0x00)
+      if (frame[11] == 0x55 && frame[12] == 0x00) {
+        return 1;
+      }
+    }
+    return 0;
+
+  } else {  // Command data
+
+    // Tail not found
+    if (memcmp(&frame[_dataLength], _commandTail, sizeof(_commandTail))) {
+      return 0;
+    }
+
+    // Too short for command word and status
+    if (_dataLength < 4) {
+      return 0;
+    }
+
+    // Acknowledge for command data
+    uint16_t cmd = _charToUint(frame[1], frame[0]) - 1;
+
+    bool fail = _charToUint(frame[2], frame[3]) != 0;
+
+    switch (cmd) {
+      case READ_PARAMETER:
+        // parameter header
+        if (_dataLength < 28 || frame[4] != 0xAA) {
+          return 0;
+        }
+
+        _parameter.maxGate           = frame[5];
+        _parameter.maxMovingGate     = frame[6];
+        _parameter.maxStationaryGate = frame[7];
+
+        for (uint8_t gate = 0; gate <= 8; gate++) {
+          _parameter.movingSensitivity[gate] = frame[8 + gate];
+        }
+
+        for (uint8_t gate = 0; gate <= 8; gate++) {
+          _parameter.stationarySensitivity[gate] = frame[17 + gate];
+        }
+
+        _parameter.detectionTime = _charToUint(frame[26], frame[27]);
+        break;
+      case READ_FIRMWARE_VERSION:
+        if (_dataLength < 12) {
+          return 0;
+        }
+
+        _firmwareVersion.minorVersion  = frame[6];
+        _firmwareVersion.majorVersion  = frame[7];
+        _firmwareVersion.bugFixVersion = uint32_t(
+            frame[8] | frame[9] << 8 |
+            frame[10] << 16 | frame[11] << 24);
+
+        break;
+
+      default:
+        // TODO Protocol version, radar buffer size...
+        break;
+    }
+
+    return cmd + fail;
+  }
 }
 
 bool LD2410::_enableConfigMode() {
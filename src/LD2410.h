@@ -50,7 +50,7 @@ class LD2410 {
     uint8_t movingTargetEnergy;         // moving target energy value 0-100 %
     uint16_t stationaryTargetDistance;  // stationary target distance in cm
     uint8_t stationaryTargetEnergy;     // stationary target energy value 0-100 %
-    uint8_t detectionDistance;          // detection distance in cm
+    uint16_t detectionDistance;         // detection distance in cm
   };
 
   /**
@@ -132,13 +132,13 @@ class LD2410 {
   bool _sendRequestToRadar(RadarCommand cmd, const uint8_t* data, size_t dataSize);
 
   /**
-   * @brief Helper function to convert tow char to an uint16_t
+   * @brief Helper function to convert two bytes to an uint16_t
    *
-   * @param c1 Char 1
-   * @param c2 Char 2
+   * @param c1 low byte
+   * @param c2 high byte
    * @return uint16_t converted value
    */
-  uint16_t _charToUint(char c1, char c2);
+  uint16_t _charToUint(uint8_t c1, uint8_t c2);
 
   /**
    * @brief Receive and parse data from the radar
@@ -147,6 +147,25 @@ class LD2410 {
    */
   uint16_t _parse();
 
+  /**
+   * @brief Parse received data from a buffer, complete frames are decoded in
+   * place and only frames split between two calls are copied
+   *
+   * @param data received data
+   * @param size size of the data
+   * @param parsed number of parsed bytes, the parser stops after a frame
+   * @return uint16_t > 0 Received new data or the Acknowledge for a command
+   */
+  uint16_t _parse(const uint8_t* data, size_t size, size_t& parsed);
+
+  /**
+   * @brief Decode a received frame
+   *
+   * @param frame frame data followed by the frame tail
+   * @return uint16_t > 0 Received new data or the Acknowledge for a command
+   */
+  uint16_t _decodeFrame(const uint8_t* frame);
+
   /**
    * @brief Enables the configuration mode on the LD2410
    *
@@ -164,16 +183,16 @@ class LD2410 {
   bool _disableConfigMode();
 
   // readed firmware version of the radar
-  FirmwareVersion _firmwareVersion;
+  FirmwareVersion _firmwareVersion = {};
 
   // parameters from the radar
-  Parameter _parameter;     
+  Parameter _parameter = {};     
 
   // cyclic data of from the radar         
-  CyclicData _cyclicData; 
+  CyclicData _cyclicData = {}; 
 
   // engineering data from the radar          
-  EngineeringData _engineeringData;  
+  EngineeringData _engineeringData = {};  
 
   // Data Header
   const uint8_t _dataHeader[4] = {0XF4, 0xF3, 0XF2, 0xF1};
@@ -190,6 +209,21 @@ class LD2410 {
   // radars uart port
   Stream* _radarUart;
 
+  // parser state, kept per instance so several radars can be parsed at once
+  ParserState _parserState = FIND_FRAME_HEADER;
+
+  // true if the received frame is a data frame, false for a command frame
+  bool _dataPayload = false;
+
+  // length of the frame data
+  uint16_t _dataLength = 0;
+
+  // number of already received bytes of the header, length or split frame
+  uint8_t _receivedBytes = 0;
+
+  // receive buffer for frames which are split
+  uint8_t _dataBuffer[40] = {};
+
  public:
   /**
    * @brief Constructor
@@ -220,6 +254,18 @@ class LD2410 {
    */
   bool read();
 
+  /**
+   * @brief Parse data which was received without the Stream, e.g. from the
+   * receive buffer of a serial port. Acknowledges are ignored.
+   *
+   * @param data received data
+   * @param size size of the data
+   * @param parsed number of parsed bytes, the parser stops after a data frame
+   * @return true Received a new data frame from the radar
+   * @return false no new data frame in the data
+   */
+  bool read(const uint8_t* data, size_t size, size_t& parsed);
+
   /**
    * @brief Configure the radars maximums detection range for moving and
    * stationary targets.
@@ -0,0 +1,499 @@
+#include "LD2410Emulator.h"
+
+// radar commands in the byte order they are sent over the uart
+static const uint16_t ENABLE_CONFIG_MODE       = 0xFF00;
+static const uint16_t DISABLE_CONFIG_MODE      = 0xFE00;
+static const uint16_t SET_MAX_DIST_AND_DUR     = 0x6000;
+static const uint16_t READ_PARAMETER           = 0x6100;
+static const uint16_t ENABLE_ENGINEERING_MODE  = 0x6200;
+static const uint16_t DISABLE_ENGINEERING_MODE = 0x6300;
+static const uint16_t SET_GATE_SENS_CONFIG     = 0x6400;
+static const uint16_t READ_FIRMWARE_VERSION    = 0xA000;
+static const uint16_t SET_BAUDRATE             = 0xA100;
+static const uint16_t FACTORY_RESET            = 0xA200;
+static const uint16_t RESTART                  = 0xA300;
+
+// frame header and tails
+static const uint8_t DATA_HEADER[4]    = {0XF4, 0xF3, 0XF2, 0xF1};
+static const uint8_t DATA_TAIL[4]      = {0xF8, 0xF7, 0xF6, 0xF5};
+static const uint8_t COMMAND_HEADER[4] = {0XFD, 0xFC, 0XFB, 0xFA};
+static const uint8_t COMMAND_TAIL[4]   = {0x04, 0x03, 0x02, 0x01};
+
+// the radar sends a data frame every 100ms
+static const unsigned long FRAME_INTERVAL = 100;
+
+// distance of a gate in cm
+static const uint16_t GATE_DISTANCE = 75;
+
+// emulated firmware version V1.07.22091615
+static const uint8_t FIRMWARE_MAJOR    = 0x01;
+static const uint8_t FIRMWARE_MINOR    = 0x07;
+static const uint32_t FIRMWARE_BUG_FIX = 0x22091615;
+
+// factory defaults of the radar
+static const LD2410Emulator::Parameter DEFAULT_PARAMETER = {
+    8,                                     // maxGate
+    8,                                     // maxMovingGate
+    8,                                     // maxStationaryGate
+    {50, 50, 40, 30, 20, 15, 15, 15, 15},  // movingSensitivity
+    {0, 0, 40, 40, 30, 30, 20, 20, 20},    // stationarySensitivity
+    5                                      // detectionTime
+};
+
+LD2410Emulator::LD2410Emulator() {
+  memset(&_faults, 0, sizeof(_faults));
+  memset(&_statistics, 0, sizeof(_statistics));
+  setTarget(0, 0, 0, 0);
+  reset();
+}
+
+LD2410Emulator::~LD2410Emulator() {
+}
+
+void LD2410Emulator::setTarget(uint16_t movingTargetDistance, uint8_t movingTargetEnergy,
+                               uint16_t stationaryTargetDistance, uint8_t stationaryTargetEnergy) {
+  _target.duration                 = 0;
+  _target.movingTargetDistance     = movingTargetDistance;
+  _target.movingTargetEnergy       = movingTargetEnergy;
+  _target.stationaryTargetDistance = stationaryTargetDistance;
+  _target.stationaryTargetEnergy   = stationaryTargetEnergy;
+
+  setScript(&_target, 1);
+}
+
+void LD2410Emulator::setScript(const ScriptStep *steps, size_t stepCount) {
+  // an empty script reports the target of setTarget()
+  if (steps == NULL || stepCount == 0) {
+    steps     = &_target;
+    stepCount = 1;
+  }
+
+  _script      = steps;
+  _scriptSize  = stepCount;
+  _scriptStart = millis();
+}
+
+void LD2410Emulator::setFaults(const Faults &faults) {
+  _faults = faults;
+}
+
+void LD2410Emulator::reset() {
+  _parameter       = DEFAULT_PARAMETER;
+  _baudRate        = BAUD_256000;
+  _nextBaudRate    = BAUD_256000;
+  _configMode      = false;
+  _engineeringMode = false;
+  _lastFrame       = millis();
+  _txHead          = 0;
+  _txCount         = 0;
+  _rxCount         = 0;
+  _ackSize         = 0;
+}
+
+bool LD2410Emulator::configMode() const {
+  return _configMode;
+}
+
+bool LD2410Emulator::engineeringMode() const {
+  return _engineeringMode;
+}
+
+BaudRateIndex LD2410Emulator::baudRate() const {
+  return _baudRate;
+}
+
+int LD2410Emulator::available() {
+  _update();
+  return _txCount;
+}
+
+int LD2410Emulator::read() {
+  _update();
+
+  if (_txCount == 0) {
+    return -1;
+  }
+
+  uint8_t data = _txBuffer[_txHead];
+  _txHead      = (_txHead + 1) % sizeof(_txBuffer);
+  _txCount--;
+  return data;
+}
+
+int LD2410Emulator::peek() {
+  _update();
+
+  if (_txCount == 0) {
+    return -1;
+  }
+  return _txBuffer[_txHead];
+}
+
+size_t LD2410Emulator::write(uint8_t data) {
+  _receive(data);
+  return 1;
+}
+
+void LD2410Emulator::flush() {
+  // written bytes are processed immediately
+}
+
+void LD2410Emulator::_update() {
+  unsigned long now = millis();
+
+  // send the acknowledge after the ack delay
+  if (_ackSize && now - _ackTime >= _faults.ackDelay) {
+    _sendFrame(_ackFrame, _ackSize);
+    _ackSize = 0;
+  }
+
+  // the radar doesn´t send data frames in configuration mode
+  if (_configMode) {
+    _lastFrame = now;
+    return;
+  }
+
+  // frames which don´t fit into the buffer are lost, skip them without building them
+  unsigned long dueFrames = (now - _lastFrame) / FRAME_INTERVAL;
+  unsigned long maxFrames = sizeof(_txBuffer) / (6 + 13 + sizeof(DATA_TAIL));
+
+  if (dueFrames > maxFrames) {
+    _statistics.framesOverflowed += dueFrames - maxFrames;
+    _lastFrame += (dueFrames - maxFrames) * FRAME_INTERVAL;
+  }
+
+  // send every data frame which is due
+  while (now - _lastFrame >= FRAME_INTERVAL) {
+    _lastFrame += FRAME_INTERVAL;
+    _sendDataFrame();
+  }
+}
+
+void LD2410Emulator::_receive(uint8_t data) {
+  // search the command header
+  if (_rxCount < sizeof(COMMAND_HEADER)) {
+    if (data == COMMAND_HEADER[_rxCount]) {
+      _rxBuffer[_rxCount++] = data;
+    } else {
+      // the byte could be the start of a new header
+      _rxCount = 0;
+      if (data == COMMAND_HEADER[0]) {
+        _rxBuffer[_rxCount++] = data;
+      }
+    }
+    return;
+  }
+
+  _rxBuffer[_rxCount++] = data;
+
+  // header + data length received
+  if (_rxCount < sizeof(COMMAND_HEADER) + 2) {
+    return;
+  }
+
+  uint16_t dataLength = _rxBuffer[4] | _rxBuffer[5] << 8;
+  size_t frameSize    = sizeof(COMMAND_HEADER) + 2 + dataLength + sizeof(COMMAND_TAIL);
+
+  // buffer overflow check, a command has at least the command word
+  if (dataLength < 2 || frameSize > sizeof(_rxBuffer)) {
+    _rxCount = 0;
+    return;
+  }
+
+  if (_rxCount < frameSize) {
+    return;
+  }
+
+  _rxCount = 0;
+
+  // Tail not found
+  if (memcmp(&_rxBuffer[frameSize - sizeof(COMMAND_TAIL)], COMMAND_TAIL, sizeof(COMMAND_TAIL))) {
+    return;
+  }
+
+  _statistics.commandsReceived++;
+
+  uint16_t cmd = _rxBuffer[6] << 8 | _rxBuffer[7];
+  _executeCommand(cmd, &_rxBuffer[8], dataLength - 2);
+}
+
+void LD2410Emulator::_executeCommand(uint16_t cmd, const uint8_t *data, size_t dataSize) {
+  if (cmd == ENABLE_CONFIG_MODE) {
+    _configMode = true;
+
+    uint8_t ack[4] = {
+        0x01, 0x00,  // protocol version
+        0x40, 0x00   // buffer size
+    };
+    _acknowledge(cmd, true, ack, sizeof(ack));
+    return;
+  }
+
+  // the radar ignores all other commands outside the configuration mode
+  if (!_configMode) {
+    return;
+  }
+
+  switch (cmd) {
+    case DISABLE_CONFIG_MODE:
+      _configMode = false;
+      _acknowledge(cmd, true, NULL, 0);
+      break;
+
+    case SET_MAX_DIST_AND_DUR:
+    case SET_GATE_SENS_CONFIG: {
+      if (dataSize != 18) {
+        _acknowledge(cmd, false, NULL, 0);
+        break;
+      }
+
+      // three command words with a 32bit value each
+      uint32_t value[3];
+      for (uint8_t word = 0; word < 3; word++) {
+        const uint8_t *p = &data[word * 6];
+        if ((p[0] | p[1] << 8) != word) {
+          _acknowledge(cmd, false, NULL, 0);
+          return;
+        }
+        value[word] = uint32_t(p[2] | p[3] << 8 | p[4] << 16 | uint32_t(p[5]) << 24);
+      }
+
+      if (cmd == SET_MAX_DIST_AND_DUR) {
+        if (value[0] < 2 || value[0] > 8 || value[1] < 2 || value[1] > 8 || value[2] > 0xFFFF) {
+          _acknowledge(cmd, false, NULL, 0);
+          break;
+        }
+        _parameter.maxMovingGate     = value[0];
+        _parameter.maxStationaryGate = value[1];
+        _parameter.detectionTime     = value[2];
+      } else {
+        // gate 0xFFFF sets the sensitivity of all gates
+        bool allGates = (value[0] == 0xFFFF);
+        if ((value[0] > 8 && !allGates) || value[1] > 100 || value[2] > 100) {
+          _acknowledge(cmd, false, NULL, 0);
+          break;
+        }
+        for (uint8_t gate = 0; gate <= 8; gate++) {
+          if (allGates || gate == value[0]) {
+            _parameter.movingSensitivity[gate]     = value[1];
+            _parameter.stationarySensitivity[gate] = value[2];
+          }
+        }
+      }
+      _acknowledge(cmd, true, NULL, 0);
+      break;
+    }
+
+    case READ_PARAMETER: {
+      uint8_t ack[24];
+      ack[0] = 0xAA;  // parameter header
+      ack[1] = _parameter.maxGate;
+      ack[2] = _parameter.maxMovingGate;
+      ack[3] = _parameter.maxStationaryGate;
+      memcpy(&ack[4], _parameter.movingSensitivity, 9);
+      memcpy(&ack[13], _parameter.stationarySensitivity, 9);
+      ack[22] = lowByte(_parameter.detectionTime);
+      ack[23] = highByte(_parameter.detectionTime);
+      _acknowledge(cmd, true, ack, sizeof(ack));
+      break;
+    }
+
+    case ENABLE_ENGINEERING_MODE:
+    case DISABLE_ENGINEERING_MODE:
+      _engineeringMode = (cmd == ENABLE_ENGINEERING_MODE);
+      _acknowledge(cmd, true, NULL, 0);
+      break;
+
+    case READ_FIRMWARE_VERSION: {
+      uint8_t ack[8] = {
+          0x01, 0x00,  // firmware type
+          FIRMWARE_MINOR,
+          FIRMWARE_MAJOR,
+          uint8_t(FIRMWARE_BUG_FIX),
+          uint8_t(FIRMWARE_BUG_FIX >> 8),
+          uint8_t(FIRMWARE_BUG_FIX >> 16),
+          uint8_t(FIRMWARE_BUG_FIX >> 24)};
+      _acknowledge(cmd, true, ack, sizeof(ack));
+      break;
+    }
+
+    case SET_BAUDRATE:
+      // the new baud rate gets active after a restart
+      if (dataSize != 2 || data[0] < BAUD_9600 || data[0] > BAUD_460800 || data[1] != 0x00) {
+        _acknowledge(cmd, false, NULL, 0);
+        break;
+      }
+      _nextBaudRate = BaudRateIndex(data[0]);
+      _acknowledge(cmd, true, NULL, 0);
+      break;
+
+    case FACTORY_RESET:
+      _parameter    = DEFAULT_PARAMETER;
+      _nextBaudRate = BAUD_256000;
+      _acknowledge(cmd, true, NULL, 0);
+      break;
+
+    case RESTART:
+      _acknowledge(cmd, true, NULL, 0);
+      _configMode      = false;
+      _engineeringMode = false;
+      _baudRate        = _nextBaudRate;
+      break;
+
+    default:
+      _acknowledge(cmd, false, NULL, 0);
+      break;
+  }
+}
+
+void LD2410Emulator::_acknowledge(uint16_t cmd, bool success, const uint8_t *data, size_t dataSize) {
+  // a pending acknowledge is sent before the new one
+  if (_ackSize) {
+    _sendFrame(_ackFrame, _ackSize);
+  }
+
+  uint16_t dataLength = 4 + dataSize;
+  uint8_t *p          = _ackFrame;
+
+  memcpy(p, COMMAND_HEADER, sizeof(COMMAND_HEADER));
+  p += sizeof(COMMAND_HEADER);
+  *p++ = lowByte(dataLength);
+  *p++ = highByte(dataLength);
+
+  // acknowledge word is the command word | 0x0100
+  *p++ = highByte(cmd);
+  *p++ = lowByte(cmd) | 0x01;
+
+  // status 0 = success, 1 = failed
+  *p++ = success ? 0x00 : 0x01;
+  *p++ = 0x00;
+
+  if (dataSize) {
+    memcpy(p, data, dataSize);
+    p += dataSize;
+  }
+  memcpy(p, COMMAND_TAIL, sizeof(COMMAND_TAIL));
+  p += sizeof(COMMAND_TAIL);
+
+  _ackSize = p - _ackFrame;
+  _ackTime = millis();
+
+  if (_faults.ackDelay == 0) {
+    _sendFrame(_ackFrame, _ackSize);
+    _ackSize = 0;
+  }
+}
+
+void LD2410Emulator::_sendDataFrame() {
+  const ScriptStep &step = _currentStep(millis());
+
+  uint8_t movingGate     = min(step.movingTargetDistance / GATE_DISTANCE, 8);
+  uint8_t stationaryGate = min(step.stationaryTargetDistance / GATE_DISTANCE, 8);
+
+  // the radar only reports targets inside the configured gates with enough energy
+  bool moving = step.movingTargetEnergy > 0 &&
+                movingGate <= _parameter.maxMovingGate &&
+                step.movingTargetEnergy >= _parameter.movingSensitivity[movingGate];
+
+  bool stationary = step.stationaryTargetEnergy > 0 &&
+                    stationaryGate <= _parameter.maxStationaryGate &&
+                    step.stationaryTargetEnergy >= _parameter.stationarySensitivity[stationaryGate];
+
+  uint8_t targetState         = (moving ? MOVING_TARGET : NO_TARGET) | (stationary ? STATIONARY_TARGET : NO_TARGET);
+  uint16_t movingDistance     = moving ? step.movingTargetDistance : 0;
+  uint16_t stationaryDistance = stationary ? step.stationaryTargetDistance : 0;
+  uint16_t detectionDistance  = 0;
+
+  if (moving && stationary) {
+    detectionDistance = min(movingDistance, stationaryDistance);
+  } else if (moving || stationary) {
+    detectionDistance = moving ? movingDistance : stationaryDistance;
+  }
+
+  uint8_t dataLength = _engineeringMode ? 35 : 13;
+  uint8_t frame[4 + 2 + 35 + 4];
+  uint8_t *data = &frame[6];
+
+  memcpy(frame, DATA_HEADER, sizeof(DATA_HEADER));
+  frame[4] = dataLength;
+  frame[5] = 0x00;
+
+  data[0]  = _engineeringMode ? 0x01 : 0x02;  // data type
+  data[1]  = 0xAA;                            // cyclicData header
+  data[2]  = targetState;
+  data[3]  = lowByte(movingDistance);
+  data[4]  = highByte(movingDistance);
+  data[5]  = moving ? step.movingTargetEnergy : 0;
+  data[6]  = lowByte(stationaryDistance);
+  data[7]  = highByte(stationaryDistance);
+  data[8]  = stationary ? step.stationaryTargetEnergy : 0;
+  data[9]  = lowByte(detectionDistance);
+  data[10] = highByte(detectionDistance);
+
+  if (_engineeringMode) {
+    data[11] = _parameter.maxMovingGate;
+    data[12] = _parameter.maxStationaryGate;
+
+    // the energy of a target is reported on its gate
+    for (uint8_t gate = 0; gate <= 8; gate++) {
+      data[13 + gate] = (gate == movingGate) ? step.movingTargetEnergy : 0;
+      data[22 + gate] = (gate == stationaryGate) ? step.stationaryTargetEnergy : 0;
+    }
+
+    data[31] = step.movingTargetEnergy;
+    data[32] = step.stationaryTargetEnergy;
+  }
+
+  // cyclicData tail and check
+  data[dataLength - 2] = 0x55;
+  data[dataLength - 1] = 0x00;
+
+  memcpy(&data[dataLength], DATA_TAIL, sizeof(DATA_TAIL));
+
+  _sendFrame(frame, 6 + dataLength + sizeof(DATA_TAIL));
+}
+
+void LD2410Emulator::_sendFrame(uint8_t *frame, size_t frameSize) {
+  if (random(100) < _faults.dropRate) {
+    _statistics.framesDropped++;
+    return;
+  }
+
+  // frames are only sent completely
+  if (_txCount + frameSize > sizeof(_txBuffer)) {
+    _statistics.framesOverflowed++;
+    return;
+  }
+
+  // flip a random bit of the frame
+  if (random(100) < _faults.corruptionRate) {
+    frame[random(frameSize)] ^= 1 << random(8);
+    _statistics.framesCorrupted++;
+  }
+
+  for (size_t i = 0; i < frameSize; i++) {
+    _txBuffer[(_txHead + _txCount++) % sizeof(_txBuffer)] = frame[i];
+  }
+  _statistics.framesSent++;
+}
+
+const LD2410Emulator::ScriptStep &LD2410Emulator::_currentStep(unsigned long now) const {
+  uint32_t scriptDuration = 0;
+  for (size_t i = 0; i < _scriptSize; i++) {
+    scriptDuration += _script[i].duration;
+  }
+
+  if (scriptDuration == 0) {
+    return _script[0];
+  }
+
+  // the script is played in a loop
+  uint32_t time = (now - _scriptStart) % scriptDuration;
+  for (size_t i = 0; i < _scriptSize; i++) {
+    if (time < _script[i].duration) {
+      return _script[i];
+    }
+    time -= _script[i].duration;
+  }
+  return _script[0];
+}
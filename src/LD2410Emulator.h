@@ -0,0 +1,220 @@
+#pragma once
+
+#include <Arduino.h>
+
+#include "LD2410.h"
+
+/**
+ * @brief Software emulation of a LD2410 radar.
+ *
+ * The emulator is a Stream and can be passed to the LD2410 class instead of
+ * the radars uart. Commands written to it are answered like the real radar
+ * does and data frames of scripted targets are sent at the radars frame rate.
+ */
+class LD2410Emulator : public Stream {
+ public:
+  /**
+   * @brief Emulated parameters of the radar
+   */
+  struct Parameter {
+    uint8_t maxGate;                   // maximum distance detection gate
+    uint8_t maxMovingGate;             // maximum gate which detects moving targets
+    uint8_t maxStationaryGate;         // maximum gate which detects static targets
+    uint8_t movingSensitivity[9];      // Energy settings per gate
+    uint8_t stationarySensitivity[9];  // Energy settings per gate
+    uint16_t detectionTime;            // Detection time in seconds
+  };
+
+  /**
+   * @brief One step of a target script
+   */
+  struct ScriptStep {
+    uint32_t duration;                  // duration of the step in ms
+    uint16_t movingTargetDistance;      // moving target distance in cm
+    uint8_t movingTargetEnergy;         // moving target energy value 0-100 %, 0 = no moving target
+    uint16_t stationaryTargetDistance;  // stationary target distance in cm
+    uint8_t stationaryTargetEnergy;     // stationary target energy value 0-100 %, 0 = no stationary target
+  };
+
+  /**
+   * @brief Faults which are injected into the frames sent by the emulator
+   */
+  struct Faults {
+    uint8_t dropRate;        // probability in % that a frame gets dropped
+    uint8_t corruptionRate;  // probability in % that a bit of a frame gets flipped
+    uint16_t ackDelay;       // delay in ms until a command gets acknowledged
+  };
+
+  /**
+   * @brief Counters of the emulator
+   */
+  struct Statistics {
+    uint32_t commandsReceived;  // number of received command frames
+    uint32_t framesSent;        // number of frames put into the receive buffer
+    uint32_t framesDropped;     // number of frames dropped by fault injection
+    uint32_t framesCorrupted;   // number of frames corrupted by fault injection
+    uint32_t framesOverflowed;  // number of frames lost because nobody read the stream
+  };
+
+  /**
+   * @brief Constructor, the emulator starts with the radars factory defaults
+   */
+  LD2410Emulator();
+
+  /**
+   * @brief Destroy the LD2410Emulator object
+   *
+   */
+  ~LD2410Emulator();
+
+  /**
+   * @brief Set a single target which is reported until it gets changed
+   *
+   * @param movingTargetDistance moving target distance in cm
+   * @param movingTargetEnergy moving target energy 0-100 %, 0 = no moving target
+   * @param stationaryTargetDistance stationary target distance in cm
+   * @param stationaryTargetEnergy stationary target energy 0-100 %, 0 = no stationary target
+   */
+  void setTarget(uint16_t movingTargetDistance, uint8_t movingTargetEnergy,
+                 uint16_t stationaryTargetDistance, uint8_t stationaryTargetEnergy);
+
+  /**
+   * @brief Set a target script which is played in a loop. The steps are not
+   * copied and must stay valid as long as the script is used.
+   *
+   * @param steps steps of the script
+   * @param stepCount number of steps
+   */
+  void setScript(const ScriptStep* steps, size_t stepCount);
+
+  /**
+   * @brief Set the faults which are injected into the sent frames
+   *
+   * @param faults faults to inject
+   */
+  void setFaults(const Faults& faults);
+
+  /**
+   * @brief Restores the factory defaults and clears the receive buffer
+   */
+  void reset();
+
+  /**
+   * @brief Check if the emulated radar is in configuration mode
+   */
+  bool configMode() const;
+
+  /**
+   * @brief Check if the emulated radar is in engineering mode
+   */
+  bool engineeringMode() const;
+
+  /**
+   * @brief Baud rate the emulated radar is currently running with
+   */
+  BaudRateIndex baudRate() const;
+
+  // Stream interface
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t data);
+  void flush();
+  using Print::write;
+
+  // Reference to the emulated parameters
+  const Parameter& parameter = _parameter;
+
+  // Reference to the emulated faults
+  const Faults& faults = _faults;
+
+  // Reference to the emulator statistics
+  const Statistics& statistics = _statistics;
+
+ private:
+  /**
+   * @brief Sends the acknowledge and the data frames which are due
+   */
+  void _update();
+
+  /**
+   * @brief Receives one byte of a command frame
+   *
+   * @param data received byte
+   */
+  void _receive(uint8_t data);
+
+  /**
+   * @brief Executes a received command and prepares its acknowledge
+   *
+   * @param cmd received command
+   * @param data command data
+   * @param dataSize size of the command data
+   */
+  void _executeCommand(uint16_t cmd, const uint8_t* data, size_t dataSize);
+
+  /**
+   * @brief Prepares the acknowledge of a command, it gets sent after the ack delay
+   *
+   * @param cmd acknowledged command
+   * @param success true if the command was executed successfully
+   * @param data acknowledge data
+   * @param dataSize size of the acknowledge data
+   */
+  void _acknowledge(uint16_t cmd, bool success, const uint8_t* data, size_t dataSize);
+
+  /**
+   * @brief Sends a data frame of the current target
+   */
+  void _sendDataFrame();
+
+  /**
+   * @brief Puts a frame into the receive buffer, faults are injected here
+   *
+   * @param frame frame to send
+   * @param frameSize size of the frame
+   */
+  void _sendFrame(uint8_t* frame, size_t frameSize);
+
+  /**
+   * @brief Returns the script step which is active at the given time
+   */
+  const ScriptStep& _currentStep(unsigned long now) const;
+
+  // emulated parameters
+  Parameter _parameter;
+
+  // injected faults
+  Faults _faults;
+
+  // emulator statistics
+  Statistics _statistics;
+
+  // active baud rate and the baud rate which gets active after a restart
+  BaudRateIndex _baudRate, _nextBaudRate;
+
+  // configuration and engineering mode
+  bool _configMode, _engineeringMode;
+
+  // target script
+  ScriptStep _target;
+  const ScriptStep* _script;
+  size_t _scriptSize;
+  unsigned long _scriptStart;
+
+  // time of the last data frame
+  unsigned long _lastFrame;
+
+  // frames which can be read by the stream
+  uint8_t _txBuffer[128];
+  uint8_t _txHead, _txCount;
+
+  // received command frame
+  uint8_t _rxBuffer[32];
+  uint8_t _rxCount;
+
+  // acknowledge which waits for the ack delay
+  uint8_t _ackFrame[40];
+  uint8_t _ackSize;
+  unsigned long _ackTime;
+};
@@ -0,0 +1,150 @@
+#if defined(__linux__)
+
+#include "LD2410Gateway.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+LD2410Gateway::LD2410Gateway() {
+  _epollFd               = -1;
+  _callback              = NULL;
+  _callbackArg           = NULL;
+  _disconnectCallback    = NULL;
+  _disconnectCallbackArg = NULL;
+
+  memset(_serial, 0, sizeof(_serial));
+  memset(_radar, 0, sizeof(_radar));
+}
+
+LD2410Gateway::~LD2410Gateway() {
+  end();
+}
+
+bool LD2410Gateway::begin() {
+  end();
+
+  _epollFd = epoll_create1(EPOLL_CLOEXEC);
+  return _epollFd >= 0;
+}
+
+void LD2410Gateway::end() {
+  if (_epollFd >= 0) {
+    close(_epollFd);
+    _epollFd = -1;
+  }
+
+  memset(_serial, 0, sizeof(_serial));
+  memset(_radar, 0, sizeof(_radar));
+}
+
+int LD2410Gateway::add(LD2410PosixSerial &serial, LD2410 &radar) {
+  if (_epollFd < 0 || serial.fd() < 0) {
+    return -1;
+  }
+
+  // lowest free index, removed radars leave a gap
+  uint8_t index = 0;
+  while (index < MAX_RADARS && _radar[index]) {
+    index++;
+  }
+  if (index >= MAX_RADARS) {
+    return -1;
+  }
+
+  // the index of the radar is stored in the event
+  struct epoll_event event;
+  event.events   = EPOLLIN;
+  event.data.u32 = index;
+
+  if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, serial.fd(), &event) < 0) {
+    return -1;
+  }
+
+  _serial[index] = &serial;
+  _radar[index]  = &radar;
+  return index;
+}
+
+void LD2410Gateway::remove(uint8_t index) {
+  if (!connected(index)) {
+    return;
+  }
+
+  // fails if the port was already closed, which also removed it from epoll
+  epoll_ctl(_epollFd, EPOLL_CTL_DEL, _serial[index]->fd(), NULL);
+
+  _serial[index] = NULL;
+  _radar[index]  = NULL;
+}
+
+bool LD2410Gateway::connected(uint8_t index) const {
+  return index < MAX_RADARS && _radar[index] != NULL;
+}
+
+void LD2410Gateway::onFrame(FrameCallback callback, void *arg) {
+  _callback    = callback;
+  _callbackArg = arg;
+}
+
+void LD2410Gateway::onDisconnect(DisconnectCallback callback, void *arg) {
+  _disconnectCallback    = callback;
+  _disconnectCallbackArg = arg;
+}
+
+int LD2410Gateway::poll(int timeout) {
+  if (_epollFd < 0) {
+    return -1;
+  }
+
+  struct epoll_event events[MAX_RADARS];
+
+  int count = epoll_wait(_epollFd, events, MAX_RADARS, timeout);
+  if (count < 0) {
+    return (errno == EINTR) ? 0 : -1;
+  }
+
+  int frames = 0;
+
+  for (int i = 0; i < count; i++) {
+    uint8_t index = events[i].data.u32;
+
+    // removed by a callback of an earlier event
+    if (!connected(index)) {
+      continue;
+    }
+
+    LD2410PosixSerial &serial = *_serial[index];
+    LD2410 &radar             = *_radar[index];
+
+    // parse the receive buffer in place until the port is drained, available()
+    // refills the empty buffer with one read() of the pending data
+    while (serial.available() > 0) {
+      size_t parsed;
+      bool frame = radar.read(serial.rxData(), serial.available(), parsed);
+      serial.skip(parsed);
+
+      if (frame) {
+        frames++;
+
+        if (_callback) {
+          _callback(index, radar, _callbackArg);
+        }
+      }
+    }
+
+    // port was closed or the adapter unplugged, stop polling it and free the index
+    if ((events[i].events & (EPOLLERR | EPOLLHUP)) && connected(index)) {
+      remove(index);
+
+      if (_disconnectCallback) {
+        _disconnectCallback(index, radar, _disconnectCallbackArg);
+      }
+    }
+  }
+
+  return frames;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include "LD2410.h"
+#include "LD2410PosixSerial.h"
+
+/**
+ * @brief Receives the data frames of many radars on a Linux host. The serial
+ * ports of the radars are multiplexed with epoll.
+ */
+class LD2410Gateway {
+ public:
+  /**
+   * @brief Callback for a received data frame
+   *
+   * @param index index of the radar returned by add()
+   * @param radar radar which received the data frame
+   * @param arg argument passed to onFrame()
+   */
+  typedef void (*FrameCallback)(uint8_t index, LD2410& radar, void* arg);
+
+  /**
+   * @brief Callback for a removed radar whose serial port was closed or
+   * unplugged, the serial port stays open and the index gets free for add()
+   *
+   * @param index index of the radar returned by add()
+   * @param radar radar which was removed
+   * @param arg argument passed to onDisconnect()
+   */
+  typedef void (*DisconnectCallback)(uint8_t index, LD2410& radar, void* arg);
+
+  // maximum number of radars per gateway
+  static const uint8_t MAX_RADARS = 64;
+
+  /**
+   * @brief Constructor
+   */
+  LD2410Gateway();
+
+  /**
+   * @brief Destroy the LD2410Gateway object
+   *
+   */
+  ~LD2410Gateway();
+
+  /**
+   * @brief Creates the epoll instance
+   *
+   * @return true Gateway started successfully
+   * @return false Failed to create the epoll instance
+   */
+  bool begin();
+
+  /**
+   * @brief Closes the epoll instance and removes all radars, the serial
+   * ports stay open
+   */
+  void end();
+
+  /**
+   * @brief Adds a radar, the serial port must be opened and also be the
+   * Stream of the radar. The lowest free index is used.
+   *
+   * @param serial opened serial port of the radar
+   * @param radar radar connected to the serial port
+   * @return int index of the radar, -1 if the radar couldn´t be added
+   */
+  int add(LD2410PosixSerial& serial, LD2410& radar);
+
+  /**
+   * @brief Removes a radar, the serial port stays open
+   *
+   * @param index index of the radar returned by add()
+   */
+  void remove(uint8_t index);
+
+  /**
+   * @brief Checks if a radar is added and its serial port wasn´t closed or
+   * unplugged
+   *
+   * @param index index of the radar returned by add()
+   * @return true Radar is polled
+   * @return false Index is free
+   */
+  bool connected(uint8_t index) const;
+
+  /**
+   * @brief Set the callback which is called for each received data frame
+   *
+   * @param callback callback function
+   * @param arg argument passed to the callback
+   */
+  void onFrame(FrameCallback callback, void* arg);
+
+  /**
+   * @brief Set the callback which is called for each disconnected radar
+   *
+   * @param callback callback function
+   * @param arg argument passed to the callback
+   */
+  void onDisconnect(DisconnectCallback callback, void* arg);
+
+  /**
+   * @brief Waits until a serial port gets readable and parses all received
+   * data, acknowledges and invalid frames are skipped. Radars whose serial
+   * port was closed or unplugged are removed (needs to be called in loop)
+   *
+   * @param timeout maximum time to wait in ms, -1 waits forever
+   * @return int number of received data frames, -1 on error
+   */
+  int poll(int timeout);
+
+ private:
+  // epoll file descriptor
+  int _epollFd;
+
+  // registered radars, NULL for a free index
+  LD2410PosixSerial* _serial[MAX_RADARS];
+  LD2410* _radar[MAX_RADARS];
+
+  // frame callback
+  FrameCallback _callback;
+  void* _callbackArg;
+
+  // disconnect callback
+  DisconnectCallback _disconnectCallback;
+  void* _disconnectCallbackArg;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#if defined(__linux__)
+
+#include "LD2410PosixSerial.h"
+
+#include <asm/termbits.h>  // termios2 for baud rates like 256000 (no <termios.h>, it conflicts)
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// timeout in ms to wait until the port accepts data again
+static const int WRITE_TIMEOUT = 100;
+
+// baud rates of the BaudRateIndex
+static const uint32_t BAUD_RATES[] = {0, 9600, 19200, 38400, 57600, 115200, 230400, 256000, 460800};
+
+LD2410PosixSerial::LD2410PosixSerial() {
+  _fd     = -1;
+  _rxHead = 0;
+  _rxTail = 0;
+}
+
+LD2410PosixSerial::~LD2410PosixSerial() {
+  end();
+}
+
+bool LD2410PosixSerial::begin(const char *device, BaudRateIndex baudRate) {
+  end();
+
+  if (baudRate < BAUD_9600 || baudRate > BAUD_460800) {
+    return false;
+  }
+
+  _fd = ::open(device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+  if (_fd < 0) {
+    return false;
+  }
+
+  struct termios2 tty;
+  if (ioctl(_fd, TCGETS2, &tty) < 0) {
+    end();
+    return false;
+  }
+
+  // raw mode 8N1 without flow control
+  tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY);
+  tty.c_oflag &= ~OPOST;
+  tty.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+  tty.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS | CBAUD | (CBAUD << IBSHIFT));
+  tty.c_cflag |= CS8 | CREAD | CLOCAL | BOTHER | (BOTHER << IBSHIFT);
+
+  // any baud rate can be set with BOTHER
+  tty.c_ispeed = BAUD_RATES[baudRate];
+  tty.c_ospeed = BAUD_RATES[baudRate];
+
+  // read() returns immediately
+  tty.c_cc[VMIN]  = 0;
+  tty.c_cc[VTIME] = 0;
+
+  if (ioctl(_fd, TCSETS2, &tty) < 0) {
+    end();
+    return false;
+  }
+
+  // discard old data of the port
+  ioctl(_fd, TCFLSH, TCIOFLUSH);
+  return true;
+}
+
+void LD2410PosixSerial::end() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+  _rxHead = 0;
+  _rxTail = 0;
+}
+
+int LD2410PosixSerial::fill() {
+  if (_fd < 0) {
+    return -1;
+  }
+
+  // start at the beginning of the buffer if all data was parsed
+  if (_rxHead == _rxTail) {
+    _rxHead = 0;
+    _rxTail = 0;
+  }
+
+  if (_rxTail == sizeof(_rxBuffer)) {
+    return 0;
+  }
+
+  ssize_t size = ::read(_fd, &_rxBuffer[_rxTail], sizeof(_rxBuffer) - _rxTail);
+  if (size < 0) {
+    return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+  }
+
+  _rxTail += size;
+  return size;
+}
+
+int LD2410PosixSerial::fd() const {
+  return _fd;
+}
+
+const uint8_t *LD2410PosixSerial::rxData() const {
+  return &_rxBuffer[_rxHead];
+}
+
+void LD2410PosixSerial::skip(size_t size) {
+  if (size > _rxTail - _rxHead) {
+    size = _rxTail - _rxHead;
+  }
+  _rxHead += size;
+}
+
+int LD2410PosixSerial::available() {
+  if (_rxHead == _rxTail) {
+    fill();
+  }
+  return _rxTail - _rxHead;
+}
+
+int LD2410PosixSerial::read() {
+  if (!available()) {
+    return -1;
+  }
+  return _rxBuffer[_rxHead++];
+}
+
+int LD2410PosixSerial::peek() {
+  if (!available()) {
+    return -1;
+  }
+  return _rxBuffer[_rxHead];
+}
+
+size_t LD2410PosixSerial::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+size_t LD2410PosixSerial::write(const uint8_t *buffer, size_t size) {
+  size_t written = 0;
+
+  while (_fd >= 0 && written < size) {
+    ssize_t res = ::write(_fd, buffer + written, size - written);
+
+    if (res >= 0) {
+      written += res;
+    } else if (errno == EAGAIN) {
+      // wait until the port accepts data again
+      struct pollfd pfd = {_fd, POLLOUT, 0};
+      if (poll(&pfd, 1, WRITE_TIMEOUT) <= 0) {
+        break;
+      }
+    } else if (errno != EINTR) {
+      break;
+    }
+  }
+
+  return written;
+}
+
+void LD2410PosixSerial::flush() {
+  // wait until all data is sent (tcdrain)
+  if (_fd >= 0) {
+    ioctl(_fd, TCSBRK, 1);
+  }
+}
+
+#endif
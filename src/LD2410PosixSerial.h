@@ -0,0 +1,91 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <Arduino.h>
+
+#include "LD2410.h"
+
+/**
+ * @brief Serial port of a Linux host (/dev/tty*) as Stream for the LD2410 class
+ *
+ * The port is opened non blocking. Received data is fetched with one bulk
+ * read() into the receive buffer. The LD2410Gateway decodes complete frames
+ * in place from this buffer.
+ */
+class LD2410PosixSerial : public Stream {
+ public:
+  /**
+   * @brief Constructor
+   */
+  LD2410PosixSerial();
+
+  /**
+   * @brief Destroy the LD2410PosixSerial object, the port gets closed
+   *
+   */
+  ~LD2410PosixSerial();
+
+  /**
+   * @brief Opens the serial port in raw mode 8N1
+   *
+   * @param device path of the serial device e.g. /dev/ttyUSB0
+   * @param baudRate baud rate of the radar
+   * @return true Port opened successfully
+   * @return false Failed to open or configure the port
+   */
+  bool begin(const char* device, BaudRateIndex baudRate = BAUD_256000);
+
+  /**
+   * @brief Closes the serial port
+   */
+  void end();
+
+  /**
+   * @brief Reads pending data of the port with one read() into the free
+   * space of the receive buffer
+   *
+   * @return int number of bytes read, 0 if no data is pending, -1 on error
+   */
+  int fill();
+
+  /**
+   * @brief File descriptor of the opened port, -1 if the port is closed
+   */
+  int fd() const;
+
+  /**
+   * @brief Received data which was not read yet, the size is returned by available()
+   */
+  const uint8_t* rxData() const;
+
+  /**
+   * @brief Removes read data from the receive buffer
+   *
+   * @param size number of bytes to remove
+   */
+  void skip(size_t size);
+
+  // Stream interface
+  int available();
+  int read();
+  int peek();
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* buffer, size_t size);
+  void flush();
+  using Print::write;
+
+ private:
+  // the port is owned by the object and can´t be copied
+  LD2410PosixSerial(const LD2410PosixSerial&)            = delete;
+  LD2410PosixSerial& operator=(const LD2410PosixSerial&) = delete;
+
+  // file descriptor of the port
+  int _fd;
+
+  // receive buffer, data is parsed directly from here
+  uint8_t _rxBuffer[256];
+  size_t _rxHead, _rxTail;
+};
+
+#endif